@@ -0,0 +1,552 @@
+#include "FileTransfer.h"
+#include "Sender.h"
+#include "Receiver.h"
+#include "Profiler.h"
+#include "Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
+
+namespace {
+    // Fisier mapat in memorie doar pentru citire; payload-urile frame-urilor pointeaza direct in el
+    class MappedFile {
+    private:
+        // spatiul de adrese al unui proces pe 32 de biti nu are loc pentru o mapare mai mare
+        static const uint64_t maxMappedSize32 = 1ULL << 30;
+
+        const uint8_t* data;
+        uint64_t size;
+#ifdef _WIN32
+        HANDLE file;
+        HANDLE mapping;
+#else
+        int fd;
+#endif
+
+    public:
+        MappedFile() : data(nullptr), size(0),
+#ifdef _WIN32
+            file(INVALID_HANDLE_VALUE), mapping(nullptr) {}
+#else
+            fd(-1) {}
+#endif
+
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path) {
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize)) {
+                return false;
+            }
+            size = static_cast<uint64_t>(fileSize.QuadPart);
+            if (size == 0) {
+                return true; // un fisier gol nu poate fi mapat
+            }
+            if (sizeof(void*) < 8 && size > maxMappedSize32) {
+                std::cerr << "Error: Input of " << size << " bytes is too large to map in a 32-bit build; use an x64 build.\n";
+                return false;
+            }
+
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                return false;
+            }
+            data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            return data != nullptr;
+#else
+            fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                return false;
+            }
+            size = static_cast<uint64_t>(st.st_size);
+            if (size == 0) {
+                return true; // un fisier gol nu poate fi mapat
+            }
+            if (sizeof(void*) < 8 && size > maxMappedSize32) {
+                std::cerr << "Error: Input of " << size << " bytes is too large to map in a 32-bit build; use an x64 build.\n";
+                return false;
+            }
+
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                return false;
+            }
+            madvise(mapped, size, MADV_SEQUENTIAL); // citire secventiala, cu read-ahead agresiv
+            data = static_cast<const uint8_t*>(mapped);
+            return true;
+#endif
+        }
+
+        void close() {
+#ifdef _WIN32
+            if (data != nullptr) {
+                UnmapViewOfFile(data);
+            }
+            if (mapping != nullptr) {
+                CloseHandle(mapping);
+            }
+            if (file != INVALID_HANDLE_VALUE) {
+                CloseHandle(file);
+            }
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (data != nullptr) {
+                munmap(const_cast<uint8_t*>(data), size);
+            }
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            fd = -1;
+#endif
+            data = nullptr;
+            size = 0;
+        }
+
+        // Elibereaza paginile rezidente din [0, upTo); maparea e doar pentru citire, deci o accesare
+        // ulterioara le reincarca din fisier
+        void release(uint64_t upTo) {
+#ifdef _WIN32
+            static const uint64_t pageSize = []() {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<uint64_t>(info.dwPageSize);
+            }();
+#else
+            static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+            upTo = std::min(upTo, size) / pageSize * pageSize;
+            if (data == nullptr || upTo == 0) {
+                return;
+            }
+#ifdef _WIN32
+            // VirtualUnlock pe pagini neblocate le scoate din working set (intoarce ERROR_NOT_LOCKED)
+            VirtualUnlock(const_cast<uint8_t*>(data), static_cast<SIZE_T>(upTo));
+#else
+            madvise(const_cast<uint8_t*>(data), upTo, MADV_DONTNEED);
+#endif
+        }
+
+        const uint8_t* getData() const { return data; }
+        uint64_t getSize() const { return size; }
+    };
+
+    // Scrie payload-urile livrate in ordine, unind payload-urile adiacente din maparea sursei
+    class FileWriter {
+    private:
+        static const uint64_t maxRunLength = 1ULL << 30; // limita unei singure scrieri (DWORD pe Windows)
+
+        uint64_t offset;
+#ifdef _WIN32
+        HANDLE file;
+#else
+        int fd;
+        std::vector<struct iovec> iov;
+#endif
+
+    public:
+        FileWriter() : offset(0),
+#ifdef _WIN32
+            file(INVALID_HANDLE_VALUE) {}
+#else
+            fd(-1) {}
+#endif
+
+        ~FileWriter() { close(); }
+
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+
+        bool open(const std::string& path) {
+            offset = 0;
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr,
+                CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            return file != INVALID_HANDLE_VALUE;
+#else
+            fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            iov.reserve(IOV_MAX);
+            return fd >= 0;
+#endif
+        }
+
+        bool writeFrames(const std::vector<Frame>& frames) {
+            PROFILE_ZONE("FileWriter::writeFrames");
+
+            // frame-urile livrate sunt bucati consecutive din aceeasi mapare; fiecare sir de
+            // payload-uri adiacente devine o singura scriere (WriteFile) sau un singur iovec (pwritev)
+#ifdef _WIN32
+            size_t next = 0;
+            while (next < frames.size()) {
+                const uint8_t* data = frames[next].payload;
+                uint64_t length = 0;
+                for (; next < frames.size() && length < maxRunLength; next++) {
+                    if (frames[next].payloadSize == 0) {
+                        continue;
+                    }
+                    if (length > 0 && frames[next].payload != data + length) {
+                        break;
+                    }
+                    if (length == 0) {
+                        data = frames[next].payload;
+                    }
+                    length += frames[next].payloadSize;
+                }
+
+                while (length > 0) {
+                    DWORD written = 0;
+                    if (!WriteFile(file, data, static_cast<DWORD>(length), &written, nullptr) || written == 0) {
+                        return false;
+                    }
+                    data += written;
+                    length -= written;
+                    offset += written;
+                }
+            }
+            return true;
+#else
+            size_t next = 0;
+            while (next < frames.size()) {
+                iov.clear();
+                for (; next < frames.size(); next++) {
+                    if (frames[next].payloadSize == 0) {
+                        continue;
+                    }
+                    const uint8_t* payload = frames[next].payload;
+                    if (!iov.empty() && static_cast<uint8_t*>(iov.back().iov_base) + iov.back().iov_len == payload &&
+                        iov.back().iov_len < maxRunLength) {
+                        iov.back().iov_len += frames[next].payloadSize; // continua sirul adiacent
+                        continue;
+                    }
+                    if (iov.size() == static_cast<size_t>(IOV_MAX)) {
+                        break;
+                    }
+                    struct iovec entry;
+                    entry.iov_base = const_cast<uint8_t*>(payload);
+                    entry.iov_len = frames[next].payloadSize;
+                    iov.push_back(entry);
+                }
+
+                // pwritev poate scrie partial; avanseaza prin vector pana la final
+                size_t first = 0;
+                while (first < iov.size()) {
+                    ssize_t written = pwritev(fd, iov.data() + first, static_cast<int>(iov.size() - first),
+                        static_cast<off_t>(offset));
+                    if (written <= 0) {
+                        return false;
+                    }
+                    offset += static_cast<uint64_t>(written);
+
+                    size_t consumed = static_cast<size_t>(written);
+                    while (first < iov.size() && consumed >= iov[first].iov_len) {
+                        consumed -= iov[first].iov_len;
+                        first++;
+                    }
+                    if (consumed > 0) {
+                        iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + consumed;
+                        iov[first].iov_len -= consumed;
+                    }
+                }
+            }
+            return true;
+#endif
+        }
+
+        void close() {
+#ifdef _WIN32
+            if (file != INVALID_HANDLE_VALUE) {
+                CloseHandle(file);
+            }
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            fd = -1;
+#endif
+        }
+    };
+
+    // Verifica daca doua cai indica acelasi fisier (inclusiv prin link-uri); un fisier inexistent nu coincide
+    bool isSameFile(const std::string& first, const std::string& second) {
+#ifdef _WIN32
+        HANDLE handles[2];
+        BY_HANDLE_FILE_INFORMATION info[2];
+        const std::string* paths[2] = { &first, &second };
+        bool valid = true;
+
+        for (int i = 0; i < 2; i++) {
+            handles[i] = CreateFileA(paths[i]->c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+            valid = valid && handles[i] != INVALID_HANDLE_VALUE && GetFileInformationByHandle(handles[i], &info[i]);
+        }
+        for (int i = 0; i < 2; i++) {
+            if (handles[i] != INVALID_HANDLE_VALUE) {
+                CloseHandle(handles[i]);
+            }
+        }
+
+        return valid && info[0].dwVolumeSerialNumber == info[1].dwVolumeSerialNumber &&
+            info[0].nFileIndexHigh == info[1].nFileIndexHigh &&
+            info[0].nFileIndexLow == info[1].nFileIndexLow;
+#else
+        struct stat firstStat;
+        struct stat secondStat;
+        if (stat(first.c_str(), &firstStat) != 0 || stat(second.c_str(), &secondStat) != 0) {
+            return false;
+        }
+        return firstStat.st_dev == secondStat.st_dev && firstStat.st_ino == secondStat.st_ino;
+#endif
+    }
+}
+
+/**
+ * Constructor for the FileTransfer class.
+ *
+ * @param windowSize The size of the sliding window
+ * @param payloadSize The number of file bytes carried by each frame
+ */
+FileTransfer::FileTransfer(uint32_t windowSize, uint32_t payloadSize)
+    : windowSize(std::max(windowSize, 1u)), payloadSize(std::max(payloadSize, 1u)) {
+}
+
+/**
+ * Transfers a file through the Selective Repeat sender and receiver over the
+ * in-process channel. The input is memory-mapped and each frame's payload
+ * points into the mapping; the receiver writes in-order payloads with batched
+ * vectored writes. Lost frames (probability lossRate, retransmissions included)
+ * are retransmitted in the next burst. The output checksum is verified at the end.
+ * Input pages that were already written are released as the transfer advances
+ * (MADV_DONTNEED on POSIX, VirtualUnlock on Windows). 32-bit builds refuse
+ * inputs above 1 GB, which would not fit in their address space.
+ * The timer and the peak RSS sample cover only the transfer loop; checksums are
+ * computed afterwards. The peak is per run where it can be reset (Linux).
+ *
+ * Limitation: Frame::payload is a pointer into the sender's mapping, so the
+ * payload bytes never cross the channel and the receiver writes straight from
+ * sender memory. This only works on the in-process channel; a real transport
+ * would have to copy the payload into its wire format when sending the frame.
+ *
+ * @param inputPath The file to send
+ * @param outputPath The file the receiver writes
+ * @param lossRate Probability that a transmission is lost on the channel (below 1.0)
+ * @return The transfer statistics
+ */
+FileTransferResult FileTransfer::transfer(const std::string& inputPath, const std::string& outputPath, double lossRate) {
+    FileTransferResult result = FileTransferResult();
+
+    if (lossRate < 0.0 || lossRate >= 1.0) {
+        std::cerr << "Error: Loss rate must be in [0.0, 1.0).\n";
+        return result;
+    }
+
+    // deschiderea iesirii trunchiaza fisierul, care ar fi chiar intrarea mapata
+    if (isSameFile(inputPath, outputPath)) {
+        std::cerr << "Error: Input and output are the same file.\n";
+        return result;
+    }
+
+    result.peakRssPerRun = Utils::resetPeakRss();
+    result.baselineRssKb = Utils::getCurrentRssKb();
+
+    MappedFile input;
+    if (!input.open(inputPath)) {
+        std::cerr << "Error: Cannot map input file " << inputPath << '\n';
+        return result;
+    }
+
+    // numarul de frame-uri vine din dimensiunea mapata, aceeasi din care se taie payload-urile;
+    // numerele de secventa sunt pe 32 de biti, iar base + windowSize trebuie sa nu depaseasca UINT32_MAX
+    uint64_t frames = (input.getSize() + payloadSize - 1) / payloadSize;
+    if (frames > UINT32_MAX - static_cast<uint64_t>(windowSize)) {
+        std::cerr << "Error: " << frames << " frames exceed the 32-bit sequence space; use a larger payload size.\n";
+        return result;
+    }
+
+    FileWriter output;
+    if (!output.open(outputPath)) {
+        std::cerr << "Error: Cannot open output file " << outputPath << '\n';
+        return result;
+    }
+
+    result.bytes = input.getSize();
+    result.frames = frames;
+
+    Sender sender(windowSize);
+    Receiver receiver(windowSize);
+    sender.setVerbose(false);
+    receiver.setVerbose(false);
+    receiver.setStreamTracking(false); // un singur stream; payload-urile se preiau cu takeDeliveredFrames
+    sender.setPayloadSource(input.getData(), input.getSize(), payloadSize);
+
+    std::vector<Frame> burst(windowSize);
+    std::vector<Frame> delivered;
+    std::vector<uint32_t> acks;
+    std::vector<uint32_t> pending; // frame-uri pierdute care asteapta retransmisia
+    acks.reserve(windowSize);
+    pending.reserve(windowSize);
+
+    uint64_t framesSent = 0;
+    uint64_t releasedBytes = 0;
+    const uint64_t releaseThreshold = 16ULL * 1024 * 1024;
+
+    // frame-urile livrate se aduna pana la ~1 MB (sau 16K frame-uri), ca fiecare scriere sa acopere multe rafale
+    std::vector<Frame> writeQueue;
+    const uint64_t writeBatchBytes = 1024 * 1024;
+    const size_t writeBatchFrames = 16 * 1024;
+    auto flushWrites = [&]() {
+        if (writeQueue.empty()) {
+            return true;
+        }
+        if (!output.writeFrames(writeQueue)) {
+            return false;
+        }
+
+        // payload-urile scrise nu mai sunt necesare; nu lasa intreaga intrare sa ramana rezidenta
+        uint64_t writtenBytes = static_cast<uint64_t>(writeQueue.back().sequenceNumber + 1) * payloadSize;
+        if (writtenBytes - releasedBytes >= releaseThreshold) {
+            input.release(writtenBytes);
+            releasedBytes = writtenBytes;
+        }
+        writeQueue.clear();
+        return true;
+    };
+    bool writeFailed = false;
+    auto start = std::chrono::steady_clock::now();
+
+    while ((framesSent < result.frames || !pending.empty()) && !writeFailed) {
+        size_t count = 0;
+        for (auto seqNum : pending) {
+            burst[count++] = sender.retransmitFrame(seqNum);
+        }
+        pending.clear();
+
+        uint64_t remaining = result.frames - framesSent;
+        size_t sent = sender.sendFrames(burst.data() + count,
+            static_cast<size_t>(std::min<uint64_t>(remaining, burst.size() - count)));
+        framesSent += sent;
+        count += sent;
+        result.transmissions += count;
+
+        for (size_t i = 0; i < count; i++) {
+            burst[i].isCorrupted = Utils::simulateChannelError(lossRate);
+        }
+
+        receiver.receiveFrames(burst.data(), count);
+        if (receiver.takeDeliveredFrames(delivered) > 0) {
+            writeQueue.insert(writeQueue.end(), delivered.begin(), delivered.end());
+            if (writeQueue.size() * static_cast<uint64_t>(payloadSize) >= writeBatchBytes ||
+                writeQueue.size() >= writeBatchFrames) {
+                writeFailed = !flushWrites();
+            }
+        }
+
+        acks.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (burst[i].isCorrupted) {
+                pending.push_back(burst[i].sequenceNumber);
+            }
+            else {
+                acks.push_back(burst[i].sequenceNumber);
+            }
+        }
+        sender.receiveAcks(acks.data(), acks.size());
+    }
+    if (!writeFailed) {
+        writeFailed = !flushWrites();
+    }
+
+    output.close();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (result.seconds > 0.0) {
+        result.megabytesPerSecond = result.bytes / (1024.0 * 1024.0) / result.seconds;
+    }
+    result.peakRssKb = Utils::getPeakRssKb(); // inainte ca checksum-urile sa citeasca fisierele intregi
+
+    // checksum-ul sursei se calculeaza dupa oprirea cronometrului, ca intrarea sa fie citita in bucla
+    result.sourceChecksum = checksum(input.getData(), input.getSize());
+    input.close();
+
+    if (writeFailed) {
+        std::cerr << "Error: Writing to " << outputPath << " failed.\n";
+        return result;
+    }
+
+    // verifica fisierul scris pe disc, nu payload-urile din memorie
+    MappedFile written;
+    if (!written.open(outputPath)) {
+        std::cerr << "Error: Cannot map output file " << outputPath << " for verification\n";
+        return result;
+    }
+    result.outputChecksum = checksum(written.getData(), written.getSize());
+    result.completed = true;
+    result.success = written.getSize() == result.bytes && result.outputChecksum == result.sourceChecksum;
+
+    return result;
+}
+
+// Checksum FNV-1a pe 64 de biti
+uint64_t FileTransfer::checksum(const uint8_t* data, uint64_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool FileTransfer::printResult(const FileTransferResult& result, double lossRate) {
+    if (!result.completed) {
+        std::cout << "Loss " << lossRate * 100 << "% | transfer failed\n";
+        return false;
+    }
+
+    const std::streamsize oldPrecision = std::cout.precision();
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Loss " << std::setw(6) << lossRate * 100 << "% | "
+        << result.bytes / (1024.0 * 1024.0) << " MB in " << result.seconds << " s | "
+        << result.megabytesPerSecond << " MB/s | "
+        << result.transmissions << " transmissions for " << result.frames << " frames | "
+        << "peak RSS " << result.peakRssKb / 1024.0 << " MB (+"
+        << (result.peakRssKb > result.baselineRssKb ? result.peakRssKb - result.baselineRssKb : 0) / 1024.0
+        << (result.peakRssPerRun ? " MB) | " : " MB, process peak) | ")
+        << "checksum " << std::hex << result.outputChecksum << std::dec
+        << (result.success ? " OK" : " MISMATCH") << '\n';
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(oldPrecision);
+
+    return result.success;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Rezultatul unui transfer de fisier
+struct FileTransferResult {
+	bool completed;				// transferul a rulat pana la capat si iesirea a fost verificata
+	bool success;				// transferul s-a incheiat si checksum-urile coincid
+	uint64_t bytes;				// dimensiunea fisierului transferat
+	double seconds;				// durata transferului (fara verificarea finala)
+	double megabytesPerSecond;	// debitul end-to-end
+	uint64_t frames;			// numarul de frame-uri distincte
+	uint64_t transmissions;		// numarul total de transmisii, inclusiv retransmisiile
+	uint64_t sourceChecksum;	// checksum-ul fisierului de intrare
+	uint64_t outputChecksum;	// checksum-ul fisierului scris
+	uint64_t baselineRssKb;		// memoria rezidenta inainte de maparea intrarii
+	uint64_t peakRssKb;			// memoria rezidenta maxima in timpul transferului
+	bool peakRssPerRun;			// false daca sistemul nu permite resetarea maximului (valoare pe tot procesul)
+};
+
+class FileTransfer {
+private:
+	uint32_t windowSize;	// dimensiunea ferestrei
+	uint32_t payloadSize;	// dimensiunea payload-ului unui frame
+
+public:
+	FileTransfer(uint32_t windowSize, uint32_t payloadSize);
+
+	/// Main methods
+	FileTransferResult transfer(const std::string& inputPath, const std::string& outputPath, double lossRate);
+
+	/// Helper methods
+	static uint64_t checksum(const uint8_t* data, uint64_t size);
+	static bool printResult(const FileTransferResult& result, double lossRate);
+};
@@ -1,9 +1,19 @@
 #include "Frame.h"
 
-// Constructor for the Frame struct
+// Constructor for the Frame struct (single stream: stream 0, stream sequence = session sequence)
 Frame createFrame(uint32_t sequenceNumber) {
+	return createFrame(sequenceNumber, 0, sequenceNumber);
+}
+
+// Constructor for a frame belonging to a specific stream
+Frame createFrame(uint32_t sequenceNumber, uint32_t streamId, uint32_t streamSeqNum) {
 	Frame frame;
 	frame.sequenceNumber = sequenceNumber;
+	frame.streamId = streamId;
+	frame.streamSeqNum = streamSeqNum;
+	frame.sendTimestamp = 0; // setat de Sender la trimitere
+	frame.payload = nullptr;
+	frame.payloadSize = 0;
 	frame.isCorrupted = false;
 	//frame.isCorrupted = (rand() % 2 == 0); // Randomly set the corruption flag
 	
@@ -3,9 +3,15 @@
 #include <cstdint>
 
 struct Frame {
-	uint32_t sequenceNumber; // Sequence number of the frame
+	uint32_t sequenceNumber; // Sequence number of the frame (per session)
+	uint32_t streamId; // Logical stream the frame belongs to
+	uint32_t streamSeqNum; // Sequence number of the frame inside its stream
+	uint64_t sendTimestamp; // Send time in microseconds (steady clock, set by Sender), used for delivery latency
+	const uint8_t* payload; // Payload bytes (not owned, points into the sender's data source; valid only in-process)
+	uint32_t payloadSize; // Number of payload bytes
 	bool isCorrupted; // Flag indicating if the frame is corrupted
 };
 
 Frame createFrame(uint32_t sequenceNumber);
+Frame createFrame(uint32_t sequenceNumber, uint32_t streamId, uint32_t streamSeqNum);
 bool isFrameValid(const Frame& frame);
\ No newline at end of file
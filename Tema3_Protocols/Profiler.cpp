@@ -0,0 +1,214 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_RDTSC 1
+#endif
+
+namespace {
+    // Numarul maxim de intervale pastrate pe fir (~8 MB); cele peste limita sunt doar numarate
+    const size_t maxSpansPerThread = 1 << 18;
+
+    // Buffer propriu fiecarui fir; zonele se adauga fara blocare
+    struct ThreadBuffer {
+        uint32_t threadId;
+        std::vector<Profiler::Span> spans;
+        uint64_t droppedSpans = 0;
+    };
+
+    // Registrul global al bufferelor; mutex-ul este luat doar la inregistrarea unui fir nou
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        uint64_t originTicks;
+        std::chrono::steady_clock::time_point originTime;
+
+        Registry() : originTicks(Profiler::readTicks()), originTime(std::chrono::steady_clock::now()) {}
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    // Creeaza registrul la pornire, astfel incat originea sa preceada prima zona
+    Registry& startupRegistry = registry();
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+            created->threadId = static_cast<uint32_t>(reg.buffers.size());
+            created->spans.reserve(1 << 16); // evita realocarile in timpul masurarii
+            buffer = created.get();
+            reg.buffers.push_back(std::move(created));
+        }
+        return *buffer;
+    }
+
+    // Calibreaza tick-urile fata de steady_clock, pe intervalul de la crearea registrului
+    double ticksPerMicrosecond() {
+        Registry& reg = registry();
+        uint64_t ticks = Profiler::readTicks() - reg.originTicks;
+        double micros = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - reg.originTime).count();
+
+        if (micros <= 0.0 || ticks == 0) {
+            return 1.0;
+        }
+        return static_cast<double>(ticks) / micros;
+    }
+
+    struct ZoneStats {
+        uint64_t count = 0;
+        uint64_t total = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+    };
+}
+
+// Citeste contorul de cicluri (rdtsc) sau, daca nu exista, steady_clock in nanosecunde
+uint64_t Profiler::readTicks() {
+#ifdef PROFILER_HAS_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Adauga un interval in bufferul firului curent
+void Profiler::recordSpan(const char* name, uint64_t start, uint64_t end) {
+    ThreadBuffer& buffer = localBuffer();
+    if (buffer.spans.size() >= maxSpansPerThread) {
+        buffer.droppedSpans++; // bufferul plin nu mai creste, ca sa nu distorsioneze memoria masurata
+        return;
+    }
+
+    Span span;
+    span.name = name;
+    span.start = start;
+    span.end = end;
+    span.threadId = buffer.threadId;
+    buffer.spans.push_back(span);
+}
+
+/**
+ * Writes all recorded spans as Chrome trace-event JSON ("X" complete events).
+ * The file can be opened in Perfetto or chrome://tracing.
+ * Each thread keeps at most maxSpansPerThread spans (the first ones recorded);
+ * later spans are dropped and only counted, see printZoneStatistics.
+ *
+ * @param path The output file path
+ * @return true if the file was written
+ */
+bool Profiler::exportChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Error: Cannot open trace file " << path << '\n';
+        return false;
+    }
+
+    Registry& reg = registry();
+    const double tpus = ticksPerMicrosecond();
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    out << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        for (const auto& span : buffer->spans) {
+            double ts = static_cast<double>(span.start - reg.originTicks) / tpus;
+            double dur = static_cast<double>(span.end - span.start) / tpus;
+
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"" << span.name << "\",\"cat\":\"protocol\",\"ph\":\"X\""
+                << ",\"ts\":" << ts << ",\"dur\":" << dur
+                << ",\"pid\":1,\"tid\":" << span.threadId << '}';
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+
+    return static_cast<bool>(out);
+}
+
+// Afiseaza statistici agregate (numar de apeluri, tick-uri total/min/mediu/max) pe zona
+void Profiler::printZoneStatistics() {
+    Registry& reg = registry();
+    std::map<std::string, ZoneStats> stats;
+    uint64_t droppedSpans = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& buffer : reg.buffers) {
+            droppedSpans += buffer->droppedSpans;
+            for (const auto& span : buffer->spans) {
+                uint64_t ticks = span.end - span.start;
+                ZoneStats& zone = stats[span.name];
+                zone.count++;
+                zone.total += ticks;
+                zone.min = std::min(zone.min, ticks);
+                zone.max = std::max(zone.max, ticks);
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string, ZoneStats>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(),
+        [](const std::pair<std::string, ZoneStats>& a, const std::pair<std::string, ZoneStats>& b) {
+            return a.second.total > b.second.total; // zonele cele mai costisitoare primele
+        });
+
+    const double tpus = ticksPerMicrosecond();
+    const std::streamsize oldPrecision = std::cout.precision();
+
+    std::cout << "Profiler Zone Statistics (ticks):\n";
+    std::cout << std::left << std::setw(28) << "Zone" << std::right
+        << std::setw(10) << "Count" << std::setw(14) << "Total"
+        << std::setw(10) << "Min" << std::setw(12) << "Avg"
+        << std::setw(12) << "Max" << std::setw(14) << "Total (us)" << '\n';
+
+    for (const auto& entry : sorted) {
+        const ZoneStats& zone = entry.second;
+        std::cout << std::left << std::setw(28) << entry.first << std::right
+            << std::setw(10) << zone.count << std::setw(14) << zone.total
+            << std::setw(10) << zone.min
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << static_cast<double>(zone.total) / zone.count
+            << std::setw(12) << zone.max
+            << std::setw(14) << static_cast<double>(zone.total) / tpus << '\n';
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(oldPrecision);
+
+    if (droppedSpans > 0) {
+        std::cout << "Dropped spans (per-thread buffer full): " << droppedSpans << '\n';
+    }
+}
+
+// Goleste toate bufferele; bufferele raman inregistrate pentru firele existente
+void Profiler::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        buffer->spans.clear();
+        buffer->droppedSpans = 0;
+    }
+}
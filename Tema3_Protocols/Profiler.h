@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Instrumentare usoara pentru caile fierbinti ale protocolului.
+// Zonele se activeaza definind ENABLE_PROFILING (ex. in PreprocessorDefinitions);
+// fara el, PROFILE_ZONE nu genereaza niciun cod.
+
+namespace Profiler {
+	// un interval masurat pentru o zona
+	struct Span {
+		const char* name;	// numele zonei (literal static)
+		uint64_t start;		// tick-uri la intrarea in zona
+		uint64_t end;		// tick-uri la iesirea din zona
+		uint32_t threadId;	// id-ul firului care a inregistrat zona
+	};
+
+	uint64_t readTicks();
+	void recordSpan(const char* name, uint64_t start, uint64_t end);
+
+	/// Export
+	// Apelati doar cand firele instrumentate nu mai inregistreaza zone.
+	// Fiecare fir pastreaza cel mult 2^18 intervale; cele in plus sunt doar numarate.
+	bool exportChromeTrace(const std::string& path);
+	void printZoneStatistics();
+	void reset();
+
+	// Masoara durata de viata a obiectului si o inregistreaza in bufferul firului curent
+	class ScopedZone {
+	private:
+		const char* name;
+		uint64_t start;
+
+	public:
+		explicit ScopedZone(const char* name) : name(name), start(readTicks()) {}
+		~ScopedZone() { recordSpan(name, start, readTicks()); }
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+	};
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+#define PROFILE_ZONE(name) Profiler::ScopedZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -1,47 +1,139 @@
 #include "Receiver.h"
+#include "Profiler.h"
+#include "Utils.h"
 #include <iostream>
 #include <algorithm>
 
 Receiver::Receiver(uint32_t windowSize) : windowSize(windowSize) {
 	expectedSeqNum = 0;
+	verbose = true;
+	trackStreams = true;
 	receivedFrames.clear();
 	buffer.clear();
 }
 
 /// Main methods
 void Receiver::receiveFrame(const Frame& frame) {
-	std::cout << "Received frame with sequence number: " << frame.sequenceNumber << "\n";
+	PROFILE_ZONE("Receiver::receiveFrame");
+
+	if (verbose) {
+		std::cout << "Received frame with sequence number: " << frame.sequenceNumber << "\n";
+	}
 
 	if (frame.isCorrupted) {
-		std::cout << "Frame " << frame.sequenceNumber << " is corrupted. Discarding.\n";
+		if (verbose) {
+			std::cout << "Frame " << frame.sequenceNumber << " is corrupted. Discarding.\n";
+		}
 		return;
 	}
 
 	if (!isInWindow(frame.sequenceNumber)) {
-		std::cout << "Frame " << frame.sequenceNumber << " is out of window. Discarding.\n";
+		if (verbose) {
+			std::cout << "Frame " << frame.sequenceNumber << " is out of window. Discarding.\n";
+		}
 		return;
 	}
 
 	if (frame.sequenceNumber == expectedSeqNum) {
-		std::cout << "Frame " << frame.sequenceNumber << " is the expected frame.\n";
+		if (verbose) {
+			std::cout << "Frame " << frame.sequenceNumber << " is the expected frame.\n";
+		}
 
 		receivedFrames.push_back(frame); // adauga frame-ul in lista de frame-uri primite
 		expectedSeqNum++; // incrementeaza numarul de secventa asteptat
+		deliverToStream(frame);
 
 		while (buffer.find(expectedSeqNum) != buffer.end()) {
-			std::cout << "Found buffered frame " << expectedSeqNum << ". Processing.\n";
+			if (verbose) {
+				std::cout << "Found buffered frame " << expectedSeqNum << ". Processing.\n";
+			}
 
 			receivedFrames.push_back(buffer[expectedSeqNum]); // adauga frame-ul din buffer in lista de frame-uri primite
 			buffer.erase(expectedSeqNum); // sterge frame-ul din buffer
 			expectedSeqNum++; // incrementeaza numarul de secventa asteptat
 		}
 	}
+	else if (buffer.find(frame.sequenceNumber) != buffer.end()) {
+		if (verbose) {
+			std::cout << "Frame " << frame.sequenceNumber << " is already buffered. Discarding duplicate.\n";
+		}
+	}
 	else {
-		std::cout << "Frame " << frame.sequenceNumber << " is out of order. Buffering.\n";
+		if (verbose) {
+			std::cout << "Frame " << frame.sequenceNumber << " is out of order. Buffering.\n";
+		}
 		buffer[frame.sequenceNumber] = frame; // adauga frame-ul in buffer
+		deliverToStream(frame); // stream-ul sau nu asteapta dupa golurile altor stream-uri
+	}
+
+	if (verbose) {
+		std::cout << "Expected sequence number: " << expectedSeqNum << "\n";
+	}
+}
+
+/// Burst methods
+// Proceseaza un set de frame-uri primite; returneaza cate au fost acceptate (livrate sau puse in buffer)
+size_t Receiver::receiveFrames(const Frame* frames, size_t count) {
+	PROFILE_ZONE("Receiver::receiveFrames");
+
+	size_t accepted = 0;
+	size_t discarded = 0;
+	size_t delivered = receivedFrames.size();
+
+	for (size_t i = 0; i < count; i++) {
+		const Frame& frame = frames[i];
+
+		if (frame.isCorrupted || !isInWindow(frame.sequenceNumber)) {
+			discarded++;
+			continue;
+		}
+		accepted++;
+
+		if (frame.sequenceNumber != expectedSeqNum) {
+			if (buffer.emplace(frame.sequenceNumber, frame).second) { // adauga frame-ul in buffer daca nu e duplicat
+				deliverToStream(frame);
+			}
+			continue;
+		}
+
+		receivedFrames.push_back(frame);
+		expectedSeqNum++;
+		deliverToStream(frame);
+
+		// livreaza frame-urile din buffer care au devenit consecutive
+		auto it = buffer.begin();
+		while (it != buffer.end() && it->first == expectedSeqNum) {
+			receivedFrames.push_back(it->second);
+			it = buffer.erase(it);
+			expectedSeqNum++;
+		}
 	}
 
-	std::cout << "Expected sequence number: " << expectedSeqNum << "\n";
+	if (verbose) {
+		delivered = receivedFrames.size() - delivered;
+		std::cout << "Received " << count << " frames: " << delivered << " delivered, "
+			<< buffer.size() << " buffered, " << discarded << " discarded. Expected sequence number: " << expectedSeqNum << "\n";
+	}
+
+	return accepted;
+}
+
+// Preda aplicatiei frame-urile livrate in ordinea sesiunii de la ultimul apel; starea stream-urilor ramane neschimbata
+size_t Receiver::takeDeliveredFrames(std::vector<Frame>& frames) {
+	frames.clear();
+	frames.swap(receivedFrames);
+	return frames.size();
+}
+
+/// Configuration
+void Receiver::setVerbose(bool verbose) {
+	this->verbose = verbose;
+}
+
+// Fara evidenta pe stream-uri, frame-urile sunt livrate doar in ordinea sesiunii (receivedFrames);
+// getStreamFrames si printStreamLatency nu mai au date, dar memoria nu creste cu fiecare frame
+void Receiver::setStreamTracking(bool enabled) {
+	trackStreams = enabled;
 }
 
 std::vector<Frame> Receiver::getSortedFrames() {
@@ -55,7 +147,51 @@ std::vector<Frame> Receiver::getSortedFrames() {
 	return sortedFrames; // returneaza vectorul de frame-uri sortate
 }
 
+std::vector<Frame> Receiver::getStreamFrames(uint32_t streamId) {
+	auto it = streams.find(streamId);
+	if (it == streams.end()) {
+		return std::vector<Frame>();
+	}
+	return it->second.deliveredFrames; // frame-urile stream-ului inca nepreluate, in ordinea livrarii
+}
+
+// Preda aplicatiei frame-urile livrate in ordine pe un stream de la ultimul apel; returneaza cate au fost preluate
+size_t Receiver::takeStreamFrames(uint32_t streamId, std::vector<Frame>& frames) {
+	frames.clear();
+	auto it = streams.find(streamId);
+	if (it == streams.end()) {
+		return 0;
+	}
+	frames.swap(it->second.deliveredFrames);
+	return frames.size();
+}
+
 /// Helper methods
+// Livreaza in ordine frame-urile unui stream, independent de golurile din celelalte stream-uri
+void Receiver::deliverToStream(const Frame& frame) {
+	if (!trackStreams) {
+		return;
+	}
+
+	StreamState& stream = streams[frame.streamId];
+	if (frame.streamSeqNum < stream.nextStreamSeqNum) {
+		return; // deja livrat
+	}
+	stream.pending.emplace(frame.streamSeqNum, frame);
+
+	uint64_t now = Utils::getMonotonicMicros();
+	auto it = stream.pending.begin();
+	while (it != stream.pending.end() && it->first == stream.nextStreamSeqNum) {
+		stream.deliveredFrames.push_back(it->second);
+		stream.deliveredCount++;
+		if (it->second.sendTimestamp != 0) { // frame-urile create direct (createFrame) nu au moment de trimitere
+			stream.latency.add(now - it->second.sendTimestamp);
+		}
+		it = stream.pending.erase(it);
+		stream.nextStreamSeqNum++;
+	}
+}
+
 bool Receiver::isInWindow(uint32_t seqNum) {
 	return (seqNum >= expectedSeqNum && seqNum < expectedSeqNum + windowSize); // verifica daca numarul de secventa este in fereastra
 }
@@ -93,4 +229,87 @@ bool Receiver::printBufferStatus() {
 		}
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+bool Receiver::printStreamLatency() {
+	std::cout << "Stream Delivery Latency (us):\n";
+	if (streams.empty()) {
+		std::cout << "No frames delivered yet.\n";
+		return true;
+	}
+
+	for (const auto& pair : streams) {
+		const StreamState& stream = pair.second;
+		std::cout << "  Stream " << pair.first << ": " << stream.deliveredCount << " delivered";
+		if (!stream.pending.empty()) {
+			std::cout << ", " << stream.pending.size() << " waiting";
+		}
+		if (stream.latency.count == 0) {
+			std::cout << '\n';
+			continue;
+		}
+
+		std::cout << ", avg " << stream.latency.total / stream.latency.count
+			<< ", p50 " << stream.latency.percentile(0.50)
+			<< ", p99 " << stream.latency.percentile(0.99)
+			<< ", max " << stream.latency.max << '\n';
+	}
+	return true;
+}
+
+/// LatencyHistogram
+namespace {
+	const size_t latencySubBuckets = 8;
+	const size_t latencyBucketCount = latencySubBuckets + 61 * latencySubBuckets; // 8 valori exacte + bitii 3..63
+
+	size_t latencyBucket(uint64_t latency) {
+		if (latency < latencySubBuckets) {
+			return static_cast<size_t>(latency); // valorile mici au bucket propriu
+		}
+		unsigned msb = 3;
+		while ((latency >> (msb + 1)) != 0) {
+			msb++;
+		}
+		size_t sub = static_cast<size_t>(latency >> (msb - 3)) & (latencySubBuckets - 1);
+		return latencySubBuckets + (msb - 3) * latencySubBuckets + sub;
+	}
+
+	// cea mai mare latenta care cade in bucket
+	uint64_t latencyBucketUpperBound(size_t bucket) {
+		if (bucket < latencySubBuckets) {
+			return bucket;
+		}
+		unsigned msb = static_cast<unsigned>((bucket - latencySubBuckets) / latencySubBuckets) + 3;
+		uint64_t sub = (bucket - latencySubBuckets) % latencySubBuckets;
+		uint64_t width = 1ULL << (msb - 3);
+		return (latencySubBuckets + sub) * width + (width - 1);
+	}
+}
+
+void LatencyHistogram::add(uint64_t latency) {
+	if (buckets.empty()) {
+		buckets.assign(latencyBucketCount, 0);
+	}
+	buckets[latencyBucket(latency)]++;
+	count++;
+	total += latency;
+	max = std::max(max, latency);
+}
+
+// Percentila (nearest-rank), rotunjita in sus la limita bucket-ului si plafonata la maxim
+uint64_t LatencyHistogram::percentile(double fraction) const {
+	if (count == 0) {
+		return 0;
+	}
+	uint64_t rank = static_cast<uint64_t>(fraction * count + 0.999999);
+	rank = std::max<uint64_t>(1, std::min(rank, count));
+
+	uint64_t seen = 0;
+	for (size_t i = 0; i < buckets.size(); i++) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			return std::min(latencyBucketUpperBound(i), max);
+		}
+	}
+	return max;
+}
@@ -3,6 +3,28 @@
 #include "Frame.h"
 #include <vector>
 #include <map>
+#include <cstddef>
+
+// Histograma logaritmica a latentelor (microsecunde): 8 sub-intervale pe fiecare putere a lui 2,
+// deci percentilele au o eroare relativa de cel mult 12.5%, iar memoria nu depinde de numarul de frame-uri
+struct LatencyHistogram {
+	uint64_t count = 0;
+	uint64_t total = 0;
+	uint64_t max = 0;
+	std::vector<uint64_t> buckets;			// alocat la primul esantion
+
+	void add(uint64_t latency);
+	uint64_t percentile(double fraction) const;
+};
+
+// Starea livrarii in ordine pentru un stream
+struct StreamState {
+	uint32_t nextStreamSeqNum = 0;			// urmatorul numar de secventa asteptat in stream
+	uint64_t deliveredCount = 0;			// numarul total de frame-uri livrate
+	std::map<uint32_t, Frame> pending;		// frame-uri primite, in asteptarea celor lipsa din stream
+	std::vector<Frame> deliveredFrames;		// frame-uri livrate in ordine, inca nepreluate de aplicatie
+	LatencyHistogram latency;				// latenta de livrare
+};
 
 class Receiver {
 private:
@@ -10,13 +32,27 @@ private:
 	std::map<uint32_t, Frame> buffer;	// buffer pentru frame-urile in asteptare
 	uint32_t expectedSeqNum;			// numarul de secventa asteptat
 	uint32_t windowSize;				// dimensiunea ferestrei
+	std::map<uint32_t, StreamState> streams; // livrare in ordine pe fiecare stream
+	bool verbose;						// afiseaza mesajele de receptie
+	bool trackStreams;					// tine evidenta livrarii si latentei pe stream-uri
+
+	void deliverToStream(const Frame& frame);
 
 public:
 	Receiver(uint32_t windowSize);
 	/// Main methods
 	void receiveFrame(const Frame& frame);
 	std::vector<Frame> getSortedFrames();
+	std::vector<Frame> getStreamFrames(uint32_t streamId);
+	/// Burst methods
+	size_t receiveFrames(const Frame* frames, size_t count);
+	size_t takeDeliveredFrames(std::vector<Frame>& frames);
+	size_t takeStreamFrames(uint32_t streamId, std::vector<Frame>& frames);
+	/// Configuration
+	void setVerbose(bool verbose);
+	void setStreamTracking(bool enabled);
 	/// Helper methods
 	bool isInWindow(uint32_t seqNum);
 	bool printBufferStatus();
+	bool printStreamLatency();
 };
\ No newline at end of file
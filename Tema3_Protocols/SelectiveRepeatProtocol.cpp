@@ -2,6 +2,7 @@
 #include "Utils.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 /**
  * Constructor for the SelectiveRepeatProtocol class.
@@ -10,7 +11,7 @@
  * @param windowSize The size of the sliding window
  */
 SelectiveRepeatProtocol::SelectiveRepeatProtocol(uint32_t windowSize)
-    : sender(windowSize), receiver(windowSize) {
+    : sender(windowSize), receiver(windowSize), windowSize(windowSize) {
     Utils::logMessage("Selective Repeat Protocol initialized with window size: " +
         std::to_string(windowSize));
 }
@@ -252,8 +253,8 @@ void SelectiveRepeatProtocol::simulateWithRandomCorruption(int numFrames, double
             Utils::printDivider();
             Utils::logMessage("Retransmitting frame " + std::to_string(seqNum));
 
-            // Create a new frame with the same sequence number
-            Frame retransmitFrame = createFrame(seqNum);
+            // Resend the original frame from the sender's window
+            Frame retransmitFrame = sender.retransmitFrame(seqNum);
 
             // Send without corruption this time (or with lower probability)
             receiver.receiveFrame(retransmitFrame);
@@ -320,4 +321,184 @@ void SelectiveRepeatProtocol::simulateWithRandomCorruption(int numFrames, double
         std::to_string(actualFramesSent + corruptedFrames.size()));
 
     Utils::printDivider('=', 70);
-}
\ No newline at end of file
+}
+
+/**
+ * Simulates burst transmission using the batched Sender/Receiver APIs.
+ * Each round fills the free window slots, corrupts frames randomly, delivers
+ * the whole burst to the receiver and applies all resulting ACKs at once.
+ * Corrupted frames are retransmitted (uncorrupted) at the start of the next burst.
+ * Frames are assigned round-robin to numStreams streams; the receiver delivers
+ * each stream in order independently, so a loss only delays its own stream.
+ *
+ * @param numFrames The number of frames to send
+ * @param corruptionRate Probability that a frame is corrupted on the channel
+ * @param numStreams The number of logical streams multiplexed over the session
+ */
+void SelectiveRepeatProtocol::simulateBurst(int numFrames, double corruptionRate, uint32_t numStreams) {
+    numFrames = std::max(numFrames, 0); // un numar negativ de frame-uri nu trimite nimic
+    numStreams = std::max(numStreams, 1u);
+
+    Utils::printDivider('=', 70);
+    Utils::logMessage("Starting Selective Repeat Protocol Burst Simulation");
+    Utils::logMessage("Number of frames: " + std::to_string(numFrames));
+    Utils::logMessage("Corruption rate: " + std::to_string(corruptionRate * 100) + "%");
+    Utils::logMessage("Streams: " + std::to_string(numStreams));
+    Utils::printDivider('=', 70);
+
+    sender = Sender(windowSize);
+    receiver = Receiver(windowSize);
+
+    std::vector<Frame> burst(windowSize * 2);
+    std::vector<uint32_t> streamIds(burst.size());
+    std::vector<Frame> streamFrames;
+    size_t streamFramesConsumed = 0;
+    std::vector<uint32_t> acks;
+    std::vector<uint32_t> pending; // frame-uri corupte care asteapta retransmisia
+    acks.reserve(burst.size());
+
+    size_t framesSent = 0;
+    size_t transmissions = 0;
+    int round = 0;
+
+    while (framesSent < static_cast<size_t>(numFrames) || !pending.empty()) {
+        Utils::printDivider();
+        Utils::logMessage("Burst " + std::to_string(round++));
+
+        // retransmisiile ocupa primele pozitii din rafala
+        size_t count = 0;
+        for (auto seqNum : pending) {
+            burst[count++] = sender.retransmitFrame(seqNum);
+        }
+        size_t retransmitted = count;
+        pending.clear();
+
+        size_t remaining = static_cast<size_t>(numFrames) - framesSent;
+        for (size_t i = 0; i < streamIds.size(); i++) {
+            streamIds[i] = static_cast<uint32_t>((framesSent + i) % numStreams);
+        }
+        size_t sent = sender.sendFrames(burst.data() + count, std::min(remaining, burst.size() - count), streamIds.data());
+        framesSent += sent;
+        count += sent;
+        transmissions += count;
+
+        // canalul corupe doar transmisiile noi
+        for (size_t i = retransmitted; i < count; i++) {
+            burst[i] = Utils::simulateCorruption(burst[i], corruptionRate);
+        }
+
+        receiver.receiveFrames(burst.data(), count);
+
+        acks.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (burst[i].isCorrupted) {
+                pending.push_back(burst[i].sequenceNumber);
+            }
+            else {
+                acks.push_back(burst[i].sequenceNumber);
+            }
+        }
+        sender.receiveAcks(acks.data(), acks.size());
+
+        // aplicatia consuma fiecare stream incremental, ca memoria sa nu creasca cu istoricul
+        for (uint32_t streamId = 0; streamId < numStreams; streamId++) {
+            streamFramesConsumed += receiver.takeStreamFrames(streamId, streamFrames);
+        }
+    }
+
+    Utils::printDivider();
+    Utils::logMessage("\n=== FINAL RESULTS ===");
+    Utils::logMessage("Sorted received frames:");
+    std::vector<Frame> sortedFrames = receiver.getSortedFrames();
+    for (const auto& frame : sortedFrames) {
+        std::cout << frame.sequenceNumber << " ";
+    }
+    std::cout << std::endl;
+
+    Utils::logMessage("Bursts: " + std::to_string(round));
+    Utils::logMessage("Frames sent: " + std::to_string(framesSent));
+    Utils::logMessage("Total transmissions: " + std::to_string(transmissions));
+    Utils::logMessage("Frames consumed from streams: " + std::to_string(streamFramesConsumed));
+
+    if (numStreams > 1) {
+        Utils::printDivider();
+        receiver.printStreamLatency();
+    }
+
+    Utils::printDivider('=', 70);
+}
+
+/**
+ * Measures the per-frame CPU cost of the single-frame API (sendFrame /
+ * receiveFrame / receiveAck) against the batched API (sendFrames /
+ * receiveFrames / receiveAcks) on a lossless channel. Logging and per-stream
+ * bookkeeping are disabled for both paths, and delivered frames are drained
+ * after every burst so memory stays bounded.
+ *
+ * @param numFrames The number of frames each path transfers
+ */
+void SelectiveRepeatProtocol::benchmarkBatching(int numFrames) {
+    numFrames = std::max(numFrames, 0);
+
+    Utils::printDivider('=', 70);
+    Utils::logMessage("Benchmark: single-frame vs batched API");
+    Utils::logMessage("Number of frames: " + std::to_string(numFrames));
+    Utils::logMessage("Window size: " + std::to_string(windowSize));
+    Utils::printDivider('=', 70);
+
+    std::vector<Frame> delivered;
+
+    // Single-frame API
+    Sender singleSender(windowSize);
+    Receiver singleReceiver(windowSize);
+    singleSender.setVerbose(false);
+    singleReceiver.setVerbose(false);
+    singleReceiver.setStreamTracking(false);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numFrames; i++) {
+        Frame frame = singleSender.sendFrame();
+        singleReceiver.receiveFrame(frame);
+        singleSender.receiveAck(frame.sequenceNumber);
+        singleReceiver.takeDeliveredFrames(delivered);
+    }
+    double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Batched API
+    Sender burstSender(windowSize);
+    Receiver burstReceiver(windowSize);
+    burstSender.setVerbose(false);
+    burstReceiver.setVerbose(false);
+    burstReceiver.setStreamTracking(false);
+
+    std::vector<Frame> burst(windowSize);
+    std::vector<uint32_t> acks(windowSize);
+    size_t framesSent = 0;
+
+    start = std::chrono::steady_clock::now();
+    while (framesSent < static_cast<size_t>(numFrames)) {
+        size_t count = burstSender.sendFrames(burst.data(),
+            std::min(burst.size(), static_cast<size_t>(numFrames) - framesSent));
+        burstReceiver.receiveFrames(burst.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            acks[i] = burst[i].sequenceNumber;
+        }
+        burstSender.receiveAcks(acks.data(), count);
+        burstReceiver.takeDeliveredFrames(delivered);
+        framesSent += count;
+    }
+    double burstSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (numFrames > 0) {
+        double singleNs = singleSeconds * 1e9 / numFrames;
+        double burstNs = burstSeconds * 1e9 / numFrames;
+
+        Utils::logMessage("Single-frame API: " + std::to_string(singleNs) + " ns/frame");
+        Utils::logMessage("Batched API: " + std::to_string(burstNs) + " ns/frame");
+        if (burstNs > 0.0) {
+            Utils::logMessage("Speedup: " + std::to_string(singleNs / burstNs) + "x");
+        }
+    }
+
+    Utils::printDivider('=', 70);
+}
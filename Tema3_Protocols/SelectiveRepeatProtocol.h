@@ -7,6 +7,7 @@ class SelectiveRepeatProtocol {
 private:
 	Sender sender; // Sender object
 	Receiver receiver; // Receiver object
+	uint32_t windowSize; // Window size shared by sender and receiver
 public:
 	SelectiveRepeatProtocol(uint32_t windowSize);
 
@@ -18,4 +19,10 @@ public:
 
 	// corupere random
 	void simulateWithRandomCorruption(int numFrames, double corruptionRate);
+
+	// transmisie in rafale folosind API-urile batch, optional multiplexata pe mai multe stream-uri
+	void simulateBurst(int numFrames, double corruptionRate, uint32_t numStreams = 1);
+
+	// compara costul pe frame al API-urilor single-frame si batch
+	void benchmarkBatching(int numFrames);
 };
\ No newline at end of file
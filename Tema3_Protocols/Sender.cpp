@@ -1,11 +1,19 @@
 #include "Sender.h"
+#include "Profiler.h"
+#include "Utils.h"
 #include <iostream>
 #include <algorithm>
 
 Sender::Sender(uint32_t windowSize) : windowSize(windowSize) {
 	base = 0;
 	nextSeqNum = 0;
+	payloadData = nullptr;
+	payloadDataSize = 0;
+	payloadSize = 0;
+	verbose = true;
 	window.clear();
+	ackMask.assign(windowSize, 0);
+	nextStreamSeqNum.assign(1, 0); // stream-ul 0 exista mereu
 }
 
 /// Main methods
@@ -13,29 +21,60 @@ bool Sender::canSendFrame() {
 	return(nextSeqNum < base + windowSize); // returneaza true daca mai pot trimite frame-uri
 }
 
-Frame Sender::sendFrame() {
+Frame Sender::sendFrame(uint32_t streamId) {
+	PROFILE_ZONE("Sender::sendFrame");
+
 	if (!canSendFrame()) {
 		std::cerr << "Error: Cannot send frame, window is full.\n";
 
-		Frame invalidFrame;
-		invalidFrame.sequenceNumber = UINT32_MAX;
+		Frame invalidFrame = createFrame(UINT32_MAX);
 		invalidFrame.isCorrupted = true;
 		return invalidFrame; // returneaza un frame invalid
 	}
 
-	Frame frame = createFrame(nextSeqNum); // creeaza un frame cu numarul de secventa curent
+	Frame frame = createFrame(nextSeqNum, streamId, takeStreamSeqNum(streamId)); // creeaza un frame cu numarul de secventa curent
+	frame.sendTimestamp = Utils::getMonotonicMicros();
+	attachPayload(frame);
 
 	window.push_back(frame); // adauga frame-ul in fereastra
 
 	nextSeqNum++; // incrementeaza numarul de secventa pentru urmatorul frame
 
-	std::cout << "Sent frame with sequence number: " << frame.sequenceNumber << "\n";
+	if (verbose) {
+		std::cout << "Sent frame with sequence number: " << frame.sequenceNumber << "\n";
+	}
 
 	return frame; // returneaza frame-ul trimis
 }
 
+// Retrimite un frame neconfirmat din fereastra, pastrand stream-ul si momentul trimiterii initiale
+Frame Sender::retransmitFrame(uint32_t seqNum) {
+	auto it = std::find_if(window.begin(), window.end(),
+							[seqNum](const Frame& frame) {
+			return frame.sequenceNumber == seqNum;
+		});
+
+	if (it == window.end()) {
+		std::cerr << "Error: Frame " << seqNum << " is not in window, cannot retransmit.\n";
+
+		Frame invalidFrame = createFrame(UINT32_MAX);
+		invalidFrame.isCorrupted = true;
+		return invalidFrame; // returneaza un frame invalid
+	}
+
+	if (verbose) {
+		std::cout << "Retransmitted frame with sequence number: " << seqNum << "\n";
+	}
+
+	return *it;
+}
+
 void Sender::receiveAck(uint32_t ackNum) {
-	std::cout << "Received ACK for frame: " << ackNum << '\n';
+	PROFILE_ZONE("Sender::receiveAck");
+
+	if (verbose) {
+		std::cout << "Received ACK for frame: " << ackNum << '\n';
+	}
 
 	auto it = std::find_if(window.begin(), window.end(), 
 							[ackNum](const Frame& frame) {
@@ -60,10 +99,14 @@ void Sender::receiveAck(uint32_t ackNum) {
 			}
 		}
 
-		std::cout << "Updated base to: " << base << '\n';
+		if (verbose) {
+			std::cout << "Updated base to: " << base << '\n';
+		}
 	}
 	else {
-		std::cout << "Frame " << ackNum << " not found in window or already acknowledged.\n";
+		if (verbose) {
+			std::cout << "Frame " << ackNum << " not found in window or already acknowledged.\n";
+		}
 	}
 }
 
@@ -75,7 +118,96 @@ void Sender::checkForTimeouts() {
 	}
 }
 
+/// Burst methods
+// Umple frames cu pana la maxFrames frame-uri cate permite fereastra; returneaza cate au fost trimise
+// streamIds (optional) indica stream-ul fiecarui frame; implicit toate merg pe stream-ul 0
+size_t Sender::sendFrames(Frame* frames, size_t maxFrames, const uint32_t* streamIds) {
+	PROFILE_ZONE("Sender::sendFrames");
+
+	size_t available = base + windowSize - nextSeqNum; // locuri libere in fereastra
+	size_t count = std::min(available, maxFrames);
+	if (count == 0) {
+		return 0;
+	}
+
+	uint64_t now = Utils::getMonotonicMicros(); // un singur timestamp pentru toata rafala
+	window.reserve(window.size() + count);
+	for (size_t i = 0; i < count; i++) {
+		uint32_t streamId = streamIds ? streamIds[i] : 0;
+		frames[i] = createFrame(nextSeqNum++, streamId, takeStreamSeqNum(streamId));
+		frames[i].sendTimestamp = now;
+		attachPayload(frames[i]);
+		window.push_back(frames[i]); // adauga frame-ul in fereastra
+	}
+
+	if (verbose) {
+		std::cout << "Sent frames " << frames[0].sequenceNumber << ".." << frames[count - 1].sequenceNumber << "\n";
+	}
+
+	return count;
+}
+
+// Aplica un set de ACK-uri intr-o singura trecere prin fereastra; returneaza cate frame-uri au fost confirmate
+size_t Sender::receiveAcks(const uint32_t* ackNums, size_t count) {
+	PROFILE_ZONE("Sender::receiveAcks");
+
+	// doar ACK-urile din [base, base + windowSize) pot confirma frame-uri din fereastra
+	for (size_t i = 0; i < count; i++) {
+		if (isInWindow(ackNums[i])) {
+			ackMask[ackNums[i] - base] = 1;
+		}
+	}
+
+	size_t before = window.size();
+	window.erase(std::remove_if(window.begin(), window.end(),
+							[this](const Frame& frame) {
+			return ackMask[frame.sequenceNumber - base] != 0;
+		}), window.end()); // sterge frame-urile confirmate din fereastra
+	size_t acked = before - window.size();
+	std::fill(ackMask.begin(), ackMask.end(), 0);
+
+	// fereastra ramane ordonata dupa numarul de secventa, deci baza este primul frame neconfirmat
+	base = window.empty() ? nextSeqNum : window.front().sequenceNumber;
+
+	if (verbose) {
+		std::cout << "Received " << count << " ACKs, " << acked << " frames acknowledged. Updated base to: " << base << '\n';
+	}
+
+	return acked;
+}
+
+/// Configuration
+// Seteaza datele trimise; frame-ul cu numarul de secventa n primeste bucata [n * payloadSize, (n + 1) * payloadSize)
+void Sender::setPayloadSource(const uint8_t* data, uint64_t size, uint32_t payloadSize) {
+	payloadData = data;
+	payloadDataSize = size;
+	this->payloadSize = payloadSize;
+}
+
+void Sender::setVerbose(bool verbose) {
+	this->verbose = verbose;
+}
+
 /// Helper methods
+// Intoarce si avanseaza numarul de secventa al stream-ului; id-urile de stream sunt intregi mici, consecutivi
+uint32_t Sender::takeStreamSeqNum(uint32_t streamId) {
+	if (streamId >= nextStreamSeqNum.size()) {
+		nextStreamSeqNum.resize(static_cast<size_t>(streamId) + 1, 0);
+	}
+	return nextStreamSeqNum[streamId]++;
+}
+
+// Leaga frame-ul de bucata sa din datele trimise, fara copiere
+void Sender::attachPayload(Frame& frame) {
+	uint64_t offset = static_cast<uint64_t>(frame.sequenceNumber) * payloadSize;
+	if (payloadData == nullptr || offset >= payloadDataSize) {
+		return;
+	}
+
+	frame.payload = payloadData + offset;
+	frame.payloadSize = static_cast<uint32_t>(std::min<uint64_t>(payloadSize, payloadDataSize - offset));
+}
+
 bool Sender::isInWindow(uint32_t seqNum) {
 	return (seqNum >= base && seqNum < base + windowSize); // verifica daca numarul de secventa este in fereastra
 }
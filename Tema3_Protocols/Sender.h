@@ -2,6 +2,7 @@
 
 #include "Frame.h"
 #include <vector>
+#include <cstddef>
 
 class Sender {
 private:
@@ -9,16 +10,34 @@ private:
 	uint32_t base; // inceputul ferestrei
 	uint32_t nextSeqNum; // urmatorul numar de secventa de trimis
 	uint32_t windowSize; // dimensiunea ferestrei
+	std::vector<uint32_t> nextStreamSeqNum; // urmatorul numar de secventa pentru fiecare stream (indexat dupa id-ul stream-ului)
+	const uint8_t* payloadData; // datele trimise, impartite in payload-uri (nu sunt detinute)
+	uint64_t payloadDataSize; // dimensiunea datelor trimise
+	uint32_t payloadSize; // dimensiunea maxima a payload-ului unui frame
+	bool verbose; // afiseaza mesajele de trimitere si confirmare
+	std::vector<uint8_t> ackMask; // ACK-urile unei rafale, marcate relativ la baza ferestrei (refolosit)
+
+	void attachPayload(Frame& frame);
+	uint32_t takeStreamSeqNum(uint32_t streamId);
 
 public:
 	Sender(uint32_t windowSize);
 	
 	/// Main methods
 	bool canSendFrame();
-	Frame sendFrame();
+	Frame sendFrame(uint32_t streamId = 0);
+	Frame retransmitFrame(uint32_t seqNum);
 	void receiveAck(uint32_t ackNum);
 	void checkForTimeouts();
 
+	/// Burst methods
+	size_t sendFrames(Frame* frames, size_t maxFrames, const uint32_t* streamIds = nullptr);
+	size_t receiveAcks(const uint32_t* ackNums, size_t count);
+
+	/// Configuration
+	void setPayloadSource(const uint8_t* data, uint64_t size, uint32_t payloadSize);
+	void setVerbose(bool verbose);
+
 	/// Helper methods
 	bool isInWindow(uint32_t seqNum);
 	bool printWndowStatus();
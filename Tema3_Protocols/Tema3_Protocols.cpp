@@ -1,7 +1,10 @@
 #include "SelectiveRepeatProtocol.h"
+#include "Profiler.h"
+#include "FileTransfer.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <string>
 
 int main()
 {
@@ -18,6 +21,10 @@ int main()
     std::cout << "1. Fixed scenario (Frame 3 corrupted)\n";
     std::cout << "2. Random corruption\n";
     //std::cout << "3. Realistic simulation with retries\n";
+    std::cout << "3. Burst transmission (batched send/receive)\n";
+    std::cout << "4. Multi-stream burst transmission\n";
+    std::cout << "5. File transfer\n";
+    std::cout << "6. Benchmark single-frame vs batched API\n";
     std::cout << "Choice: ";
 
     int choice;
@@ -43,11 +50,93 @@ int main()
         protocol.simulateWithRandomCorruption(numFrames, corruptionRate);
         break;
     }
+    case 3: {
+        int numFrames;
+        double corruptionRate;
+
+        std::cout << "\nEnter number of frames to send: ";
+        std::cin >> numFrames;
+
+        std::cout << "Enter corruption probability (0.0 to 1.0): ";
+        std::cin >> corruptionRate;
+
+        protocol.simulateBurst(numFrames, corruptionRate);
+        break;
+    }
+    case 4: {
+        int numFrames;
+        uint32_t numStreams;
+        double corruptionRate;
+
+        std::cout << "\nEnter number of frames to send: ";
+        std::cin >> numFrames;
+
+        std::cout << "Enter number of streams: ";
+        std::cin >> numStreams;
+
+        std::cout << "Enter corruption probability (0.0 to 1.0): ";
+        std::cin >> corruptionRate;
+
+        protocol.simulateBurst(numFrames, corruptionRate, numStreams);
+        break;
+    }
+    case 5: {
+        std::string inputPath;
+        std::string outputPath;
+        uint32_t windowSize;
+        uint32_t payloadSize;
+
+        std::cout << "\nEnter input file path: ";
+        std::cin >> inputPath;
+
+        std::cout << "Enter output file path: ";
+        std::cin >> outputPath;
+
+        std::cout << "Enter window size: ";
+        std::cin >> windowSize;
+
+        std::cout << "Enter payload size in bytes: ";
+        std::cin >> payloadSize;
+
+        FileTransfer fileTransfer(windowSize, payloadSize);
+        const double lossRates[] = { 0.0, 0.01, 0.05, 0.1 };
+        bool allVerified = true;
+
+        for (double lossRate : lossRates) {
+            FileTransferResult result = fileTransfer.transfer(inputPath, outputPath, lossRate);
+            allVerified = FileTransfer::printResult(result, lossRate) && allVerified;
+            if (!result.completed) {
+                break; // erorile de configurare se repeta la fiecare rata de pierdere
+            }
+        }
+
+        if (!allVerified) {
+            return 1;
+        }
+        break;
+    }
+    case 6: {
+        int numFrames;
+
+        std::cout << "\nEnter number of frames to send: ";
+        std::cin >> numFrames;
+
+        protocol.benchmarkBatching(numFrames);
+        break;
+    }
     default:
         std::cout << "Invalid choice!\n";
         return 1;
     }
 
+#ifdef ENABLE_PROFILING
+    std::cout << "\n";
+    Profiler::printZoneStatistics();
+    if (Profiler::exportChromeTrace("profile_trace.json")) {
+        std::cout << "Chrome trace written to profile_trace.json (open in Perfetto)\n";
+    }
+#endif
+
     return 0;
 
 	return 0;
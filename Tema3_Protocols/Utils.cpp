@@ -1,14 +1,27 @@
 #include "Utils.h"
 #include "Frame.h"
+#include "Profiler.h"
 #include <iostream>
 #include <random>
 #include <ctime>
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <fstream>
+#endif
 
 // Simulate channel errors (packet loss or corruption) with given probability
 bool Utils::simulateChannelError(double errorRate) {
+    PROFILE_ZONE("Utils::simulateChannelError");
+
     // Seed the random number generator if it hasn't been seeded yet
     static bool seeded = false;
     if (!seeded) {
@@ -25,6 +38,8 @@ bool Utils::simulateChannelError(double errorRate) {
 
 // Simulate frame corruption with given probability
 Frame Utils::simulateCorruption(const Frame& frame, double corruptionRate) {
+    PROFILE_ZONE("Utils::simulateCorruption");
+
     Frame result = frame;
 
     if (simulateChannelError(corruptionRate)) {
@@ -58,6 +73,73 @@ std::string Utils::getCurrentTimestamp() {
     return oss.str();
 }
 
+// Get monotonic time in microseconds, for measuring latencies
+uint64_t Utils::getMonotonicMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef __linux__
+// Read a "<key>: <value> kB" line from /proc/self/status
+static uint64_t readProcStatusKb(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':') {
+            return std::stoull(line.substr(key.size() + 1));
+        }
+    }
+    return 0;
+}
+#endif
+
+// Get the peak resident set size of the process in kilobytes (since the last resetPeakRss, where supported)
+uint64_t Utils::getPeakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize) / 1024;
+#elif defined(__linux__)
+    return readProcStatusKb("VmHWM"); // spre deosebire de ru_maxrss, VmHWM poate fi resetat
+#else
+    // For other platforms (ru_maxrss is in bytes on macOS)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#endif
+}
+
+// Get the current resident set size of the process in kilobytes
+uint64_t Utils::getCurrentRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<uint64_t>(counters.WorkingSetSize) / 1024;
+#elif defined(__linux__)
+    return readProcStatusKb("VmRSS");
+#else
+    return 0;
+#endif
+}
+
+// Reset the peak resident set size to the current one; returns false where the OS does not allow it
+bool Utils::resetPeakRss() {
+#ifdef __linux__
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return static_cast<bool>(clearRefs);
+#else
+    return false;
+#endif
+}
+
 // Log a message with timestamp
 void Utils::logMessage(const std::string& message, bool includeTimestamp) {
     if (includeTimestamp) {
@@ -2,11 +2,16 @@
 
 #include "Frame.h"
 #include <string>
+#include <cstdint>
 
 namespace Utils {
 	bool simulateChannelError(double errorRate);
 	Frame simulateCorruption(const Frame& frame, double errorRate);
 	void printDivider(char symbol = '-', int length = 50);
 	std::string getCurrentTimestamp();
+	uint64_t getMonotonicMicros();
+	uint64_t getPeakRssKb();
+	uint64_t getCurrentRssKb();
+	bool resetPeakRss();
 	void logMessage(const std::string& message, bool includeTimeStamp = true);
 }
\ No newline at end of file